@@ -0,0 +1,270 @@
+// lp2d: Two-Dimensional Linear Programming
+// https://github.com/pettni/lp2d
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+//
+// Copyright (c) 2021 Petter Nilsson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <catch2/catch.hpp>
+#include <lp2d/capture.hpp>
+#include <lp2d/lp2d.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// random rows that all contain the origin
+std::vector<std::array<double, 3>> random_rows(std::size_t n, unsigned seed)
+{
+  std::default_random_engine rng(seed);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  std::vector<std::array<double, 3>> rows;
+  rows.reserve(n);
+  for (auto i = 0u; i < n; ++i) { rows.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+  return rows;
+}
+
+}  // namespace
+
+TEST_CASE("BoxBounds", "[benchmark]")
+{
+  const lp2d::Box box{.xmin = -2, .xmax = 2, .ymin = -2, .ymax = 2};
+
+  for (const auto n : {4u, 16u, 64u, 256u}) {
+    const auto rows = random_rows(n, n);
+
+    auto rows_with_box = rows;
+    rows_with_box.push_back({1, 0, box.xmax});
+    rows_with_box.push_back({-1, 0, -box.xmin});
+    rows_with_box.push_back({0, 1, box.ymax});
+    rows_with_box.push_back({0, -1, -box.ymin});
+
+    BENCHMARK("rows n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, rows_with_box); };
+    BENCHMARK("box n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, rows, box); };
+  }
+}
+
+TEST_CASE("PreparedBase", "[benchmark]")
+{
+  std::default_random_engine rng(1);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (const auto n : {100u, 1000u, 10000u}) {
+    // tangents to the unit circle
+    std::vector<std::array<double, 3>> base;
+    for (auto i = 0u; i < n; ++i) {
+      const double t = std::numbers::pi * distr(rng);
+      base.push_back({std::cos(t), std::sin(t), 1});
+    }
+    const auto prepared = lp2d::prepare(base);
+
+    const auto rows = random_rows(4, n);
+
+    BENCHMARK("concatenated n=" + std::to_string(n) + " k=4")
+    {
+      auto all = base;
+      all.insert(all.end(), rows.begin(), rows.end());
+      return lp2d::solve(0.3, 1, all);
+    };
+    BENCHMARK("prepared n=" + std::to_string(n) + " k=4")
+    {
+      return lp2d::solve(0.3, 1, prepared, rows);
+    };
+  }
+}
+
+TEST_CASE("AnytimeQuality", "[benchmark]")
+{
+  constexpr auto n        = 1000u;
+  constexpr auto problems = 100u;
+
+  std::vector<std::vector<std::array<double, 3>>> rows;
+  std::vector<double> optimal;
+  for (auto i = 0u; i < problems; ++i) {
+    rows.push_back(random_rows(n, i));
+    const auto [x, y, status] = lp2d::solve(0.3, 1, rows.back());
+    optimal.push_back(0.3 * x + y);
+  }
+
+  // quality of returned point and certified gap, averaged over problems
+  const auto report = [&](const std::string & name, const auto & make_limits) {
+    std::size_t optimal_count = 0, feasible_count = 0;
+    double error = 0, gap = 0;
+    for (auto i = 0u; i < problems; ++i) {
+      const auto [x, y, status, g] = lp2d::solve(0.3, 1, rows[i], make_limits());
+      if (status == lp2d::Status::Optimal) {
+        ++optimal_count;
+      } else if (g < std::numeric_limits<double>::infinity()) {
+        ++feasible_count;
+        error += 0.3 * x + y - optimal[i];
+        gap += g;
+      }
+    }
+    std::printf(
+      "%-16s optimal %3zu%%  approximate %3zu%%  mean error %.2e  mean gap %.2e\n",
+      name.c_str(),
+      100 * optimal_count / problems,
+      100 * feasible_count / problems,
+      feasible_count > 0 ? error / feasible_count : 0.,
+      feasible_count > 0 ? gap / feasible_count : 0.);
+  };
+
+  const std::vector<unsigned> iterations{1, 2, 4, 6, 8, 12};
+  const std::vector<unsigned> budgets{25, 50, 100, 200, 400};
+
+  for (const auto it : iterations) {
+    report("iterations=" + std::to_string(it), [it] { return lp2d::Limits{.max_iterations = it}; });
+  }
+  for (const auto us : budgets) {
+    report("budget=" + std::to_string(us) + "us", [us] {
+      return lp2d::Limits{
+        .deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(us),
+      };
+    });
+  }
+  std::fflush(stdout);
+
+  for (const auto it : iterations) {
+    BENCHMARK("iterations=" + std::to_string(it))
+    {
+      return lp2d::solve(0.3, 1, rows.front(), lp2d::Limits{.max_iterations = it});
+    };
+  }
+}
+
+TEST_CASE("ColumnInput", "[benchmark]")
+{
+  for (const auto n : {16u, 256u, 4096u}) {
+    const auto rows = random_rows(n, n);
+
+    std::vector<double> ax, ay, b;
+    for (const auto & [ax_i, ay_i, b_i] : rows) {
+      ax.push_back(ax_i);
+      ay.push_back(ay_i);
+      b.push_back(b_i);
+    }
+
+    // what a caller with column data had to do before: pack triplets, then solve
+    BENCHMARK("packed n=" + std::to_string(n))
+    {
+      std::vector<std::array<double, 3>> packed(n);
+      for (auto i = 0u; i < n; ++i) { packed[i] = {ax[i], ay[i], b[i]}; }
+      return lp2d::solve(0.3, 1, packed);
+    };
+    BENCHMARK("columns n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, ax, ay, b); };
+  }
+}
+
+TEST_CASE("SortedInput", "[benchmark]")
+{
+  std::default_random_engine rng(1);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (const auto n : {16u, 256u, 4096u}) {
+    // edges of a polygon around the origin, in counter-clockwise order
+    std::vector<std::array<double, 3>> sorted;
+    for (auto i = 0u; i < n; ++i) {
+      const double t = 2 * std::numbers::pi * i / n;
+      sorted.push_back({std::cos(t), std::sin(t), 1.5 + distr(rng)});
+    }
+
+    // same rows in random order go through the general algorithm
+    auto shuffled = sorted;
+    std::ranges::shuffle(shuffled, rng);
+
+    BENCHMARK("general n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, shuffled); };
+    BENCHMARK("solve_sorted n=" + std::to_string(n)) { return lp2d::solve_sorted(0.3, 1, sorted); };
+    BENCHMARK("dispatched n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, sorted); };
+  }
+
+  // half-ring sensor sweep, unbounded so solve() must not dispatch
+  for (const auto n : {2u, 256u, 4096u}) {
+    std::vector<std::array<double, 3>> sorted;
+    for (auto i = 0u; i < n; ++i) {
+      const double t = std::numbers::pi * i / n;
+      sorted.push_back({std::cos(t), std::sin(t), 1.5 + distr(rng)});
+    }
+
+    auto shuffled = sorted;
+    std::ranges::shuffle(shuffled, rng);
+
+    BENCHMARK("half-ring general n=" + std::to_string(n)) { return lp2d::solve(1, -1, shuffled); };
+    BENCHMARK("half-ring sorted order n=" + std::to_string(n))
+    {
+      return lp2d::solve(1, -1, sorted);
+    };
+  }
+}
+
+TEST_CASE("CaptureOverhead", "[benchmark]")
+{
+  const auto path = (std::filesystem::temp_directory_path() / "lp2d_capture_bench.bin").string();
+
+  for (const auto n : {16u, 256u}) {
+    const auto rows = random_rows(n, n);
+
+    BENCHMARK("off n=" + std::to_string(n)) { return lp2d::solve(0.3, 1, rows); };
+
+    for (const std::size_t every : {100u, 1u}) {
+      const lp2d::Capture capture(path, {.every = every});
+      BENCHMARK("every=" + std::to_string(every) + " n=" + std::to_string(n))
+      {
+        return lp2d::solve(0.3, 1, rows);
+      };
+      std::printf("dropped %zu\n", capture.dropped());
+    }
+  }
+
+  // batches of solves from several threads at once, where shared state would be contended
+  const auto rows  = random_rows(16, 16);
+  const auto batch = [&rows]() {
+    std::array<double, 4> sums{};
+    std::vector<std::thread> threads;
+    for (auto & sum : sums) {
+      threads.emplace_back([&rows, &sum] {
+        for (auto i = 0u; i < 1000; ++i) { sum += std::get<0>(lp2d::solve(0.3, 1, rows)); }
+      });
+    }
+    for (auto & thread : threads) { thread.join(); }
+    return std::accumulate(sums.begin(), sums.end(), 0.);
+  };
+
+  BENCHMARK("off 4 threads x 1000 n=16") { return batch(); };
+
+  for (const std::size_t every : {100u, 1u}) {
+    const lp2d::Capture capture(path, {.every = every});
+    BENCHMARK("every=" + std::to_string(every) + " 4 threads x 1000 n=16") { return batch(); };
+    std::printf("dropped %zu\n", capture.dropped());
+  }
+
+  std::filesystem::remove(path);
+}
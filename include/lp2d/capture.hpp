@@ -0,0 +1,294 @@
+// lp2d: Two-Dimensional Linear Programming
+// https://github.com/pettni/lp2d
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+//
+// Copyright (c) 2021 Petter Nilsson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef LP2D__CAPTURE_HPP_
+#define LP2D__CAPTURE_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "lp2d.hpp"
+
+// Log format, native byte order:
+//
+//  header: char[4] "LP2D", uint32 version
+//  record: double cx, cy, uint32 n, double[n][3] rows, double x, y, uint8 status, uint64 ns
+
+namespace lp2d {
+
+/// @brief Problem read from a capture log
+struct Record
+{
+  Scalar cx, cy;
+  std::vector<std::array<Scalar, 3>> rows;
+  std::tuple<Scalar, Scalar, Status> result;
+  std::chrono::nanoseconds time;
+};
+
+/// @brief Options for Capture
+struct CaptureOptions
+{
+  /// record every n:th problem on each thread
+  std::size_t every{1};
+  /// bytes of encoded records that may wait for the writer before new ones are dropped
+  std::size_t buffer_size{1 << 22};
+  /// time between writes, the writer also wakes up when half of buffer_size is used
+  std::chrono::milliseconds flush_interval{10};
+};
+
+/**
+ * @brief Records problems passed to solve(cx, cy, rows) to a binary log
+ *
+ * Installs itself with set_capture() on construction. On destruction it uninstalls itself, waits
+ * for solves that use it to finish, and writes all pending records.
+ *
+ * Solving threads copy the encoded record into one of two buffers that are allocated up front,
+ * reserving space with an atomic compare-exchange, so recording never locks or allocates. A
+ * background thread swaps the buffers and writes the full one to the file. Records that do not fit
+ * are dropped and counted.
+ */
+class Capture : public CaptureSink
+{
+public:
+  /**
+   * @brief Start capturing
+   * @param path log file, truncated if it exists
+   * @param options sampling and buffer size
+   * @throws std::runtime_error if another sink is installed or the file can not be opened
+   */
+  explicit Capture(const std::string & path, const CaptureOptions & options = {})
+      : options_(options)
+  {
+    for (auto & buffer : buffers_) {
+      buffer.data = std::make_unique_for_overwrite<char[]>(options_.buffer_size);
+    }
+    buffers_[1].state = closed;
+
+    // installed first so that the log of an active capture is never truncated
+    if (!set_capture(*this, options_.every)) {
+      throw std::runtime_error("lp2d::Capture: another sink is already installed");
+    }
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+      reset_capture(*this);
+      throw std::runtime_error("lp2d::Capture: can not open " + path);
+    }
+
+    // records that arrive before the writer starts wait in the buffer
+    const std::uint32_t version = 1;
+    file_.write("LP2D", 4);
+    file_.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    writer_ = std::thread([this] { run(); });
+  }
+
+  Capture(const Capture &) = delete;
+  Capture & operator=(const Capture &) = delete;
+
+  ~Capture() override
+  {
+    reset_capture(*this);
+    {
+      const std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_one();
+    writer_.join();
+  }
+
+  void record(
+    Scalar cx,
+    Scalar cy,
+    std::span<const std::array<Scalar, 3>> rows,
+    const std::tuple<Scalar, Scalar, Status> & result,
+    std::chrono::nanoseconds time) override
+  {
+    const auto [x, y, status] = result;
+    const std::uint64_t size  = 4 * sizeof(Scalar) + sizeof(std::uint32_t) + rows.size_bytes()
+                             + sizeof(std::uint8_t) + sizeof(std::uint64_t);
+
+    for (;;) {
+      Buffer & buffer      = buffers_[active_.load()];
+      std::uint64_t state  = buffer.state.load(std::memory_order_relaxed);
+      std::uint64_t offset = 0;
+      do {
+        // swapped out by the writer, retry with the new active buffer
+        if ((state & closed) != 0) { break; }
+        offset = state / used;
+        if (offset + size > options_.buffer_size) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      } while (!buffer.state.compare_exchange_weak(state, state + size * used + 1));
+      if ((state & closed) != 0) { continue; }
+
+      char * out = buffer.data.get() + offset;
+      put(out, cx);
+      put(out, cy);
+      put(out, static_cast<std::uint32_t>(rows.size()));
+      put(out, rows.data(), rows.size_bytes());
+      put(out, x);
+      put(out, y);
+      put(out, static_cast<std::uint8_t>(status));
+      put(out, static_cast<std::uint64_t>(time.count()));
+      buffer.state.fetch_sub(1, std::memory_order_release);
+
+      // waking the writer costs more than a solve, so only do it when the buffer fills up
+      const auto half = options_.buffer_size / 2;
+      if (offset < half && offset + size >= half) { cv_.notify_one(); }
+      return;
+    }
+  }
+
+  /// @brief Number of sampled problems that were dropped because the writer fell behind
+  std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  // buffer state: closed flag, bytes used in multiples of used, records being copied below used
+  static constexpr std::uint64_t closed = std::uint64_t{1} << 63;
+  static constexpr std::uint64_t used   = std::uint64_t{1} << 20;
+
+  struct Buffer
+  {
+    std::unique_ptr<char[]> data;
+    std::atomic<std::uint64_t> state{0};
+  };
+
+  static void put(char *& out, const void * data, std::size_t size)
+  {
+    std::memcpy(out, data, size);
+    out += size;
+  }
+
+  template<typename T>
+  static void put(char *& out, const T & value)
+  {
+    put(out, &value, sizeof(T));
+  }
+
+  void run()
+  {
+    for (bool stop = false; !stop;) {
+      {
+        std::unique_lock lock(mutex_);
+        cv_.wait_for(lock, options_.flush_interval, [this] {
+          const auto state = buffers_[active_.load()].state.load(std::memory_order_relaxed);
+          return stop_ || (state & ~closed) / used >= options_.buffer_size / 2;
+        });
+        stop = stop_;
+      }
+
+      // open the other buffer, make it active, then close the full one and wait for its copies
+      const auto full = active_.load();
+      buffers_[1 - full].state = 0;
+      active_                  = 1 - full;
+      std::uint64_t state      = buffers_[full].state.fetch_or(closed);
+      while ((state & (used - 1)) != 0) {
+        std::this_thread::yield();
+        state = buffers_[full].state.load(std::memory_order_acquire);
+      }
+
+      const auto size = static_cast<std::streamsize>((state & ~closed) / used);
+      file_.write(buffers_[full].data.get(), size);
+      file_.flush();
+      buffers_[full].state = closed;
+    }
+  }
+
+  CaptureOptions options_;
+  std::ofstream file_;
+  std::thread writer_;
+
+  std::atomic<std::size_t> dropped_{0};
+
+  // records go to buffers_[active_], the other one is closed
+  std::array<Buffer, 2> buffers_;
+  std::atomic<std::size_t> active_{0};
+
+  // only used to wake up and stop the writer
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+};
+
+/**
+ * @brief Read a log written by Capture
+ * @param path log file
+ * @return records in the log, up to the first incomplete one, or empty if it is not a log
+ */
+inline std::vector<Record> read_capture(const std::string & path)
+{
+  std::ifstream file(path, std::ios::binary);
+
+  const auto read = [&file]<typename T>(T & value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+  };
+
+  std::array<char, 4> magic{};
+  std::uint32_t version{};
+  if (!read(magic) || magic != std::array{'L', 'P', '2', 'D'} || !read(version) || version != 1) {
+    return {};
+  }
+
+  std::vector<Record> ret;
+  for (;;) {
+    Record r{};
+    std::uint32_t n{};
+    if (!read(r.cx) || !read(r.cy) || !read(n)) { break; }
+
+    r.rows.resize(n);
+    auto & [x, y, status] = r.result;
+    std::uint8_t s{};
+    std::uint64_t ns{};
+    if (
+      !file.read(
+        reinterpret_cast<char *>(r.rows.data()),
+        static_cast<std::streamsize>(n * sizeof(r.rows[0])))
+      || !read(x) || !read(y) || !read(s) || !read(ns)) {
+      break;
+    }
+    status = static_cast<Status>(s);
+    r.time = std::chrono::nanoseconds(ns);
+    ret.push_back(std::move(r));
+  }
+  return ret;
+}
+
+}  // namespace lp2d
+
+#endif  // LP2D__CAPTURE_HPP_
@@ -27,17 +27,76 @@
 #define LP2D__LP2D_HPP_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <initializer_list>
 #include <limits>
+#include <numbers>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <ranges>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace lp2d {
 
 using Scalar = double;
 
-enum class Status { Optimal, PrimaryInfeasible, DualInfeasible };
+enum class Status { Optimal, PrimaryInfeasible, DualInfeasible, Approximate, InvalidInput };
+
+/// @brief Point in the plane
+struct Point
+{
+  Scalar x, y;
+};
+
+/// @brief Axis-aligned bounds xmin <= x <= xmax, ymin <= y <= ymax
+struct Box
+{
+  Scalar xmin, xmax, ymin, ymax;
+};
+
+/// @brief Rows (ax, ay, b) stored in an n x 3 matrix with arbitrary strides, not owned
+struct MatrixView
+{
+  const Scalar * data;
+  std::size_t rows;
+  /// distance between consecutive rows, e.g. 1 for column-major and 3 for row-major storage
+  std::ptrdiff_t row_stride;
+  /// distance between columns ax, ay and b, e.g. rows for column-major and 1 for row-major storage
+  std::ptrdiff_t col_stride;
+};
+
+/// @brief Limits on the effort spent in solve(), checked once per iteration
+struct Limits
+{
+  /// maximal number of candidate points to check
+  std::size_t max_iterations{std::numeric_limits<std::size_t>::max()};
+  /// time after which to give up
+  std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+};
+
+/// @brief Receiver of problems passed to solve(cx, cy, rows), see set_capture()
+class CaptureSink
+{
+public:
+  virtual ~CaptureSink() = default;
+
+  /// @brief Called after a sampled solve, see set_capture(), must not block
+  virtual void record(
+    Scalar cx,
+    Scalar cy,
+    std::span<const std::array<Scalar, 3>> rows,
+    const std::tuple<Scalar, Scalar, Status> & result,
+    std::chrono::nanoseconds time) = 0;
+};
 
 ////////////////////////////////
 ///// FORWARD DECLARATIONS /////
@@ -48,6 +107,55 @@ namespace detail {
 inline constexpr auto eps = 100 * std::numeric_limits<Scalar>::epsilon();
 inline constexpr auto inf = std::numeric_limits<Scalar>::infinity();
 
+/// @brief Sink installed with set_capture(), if any
+inline std::atomic<CaptureSink *> capture_sink{nullptr};
+
+/// @brief Number of solves that may use capture_sink, see reset_capture()
+inline std::atomic<std::size_t> capture_users{0};
+
+/// @brief Sampling period of the installed sink, and number of installs so far
+inline std::atomic<std::size_t> capture_every{1}, capture_epoch{0};
+
+/// @brief Decide if this thread records its next solve, without writing shared state
+inline bool capture_sampled()
+{
+  thread_local std::size_t epoch{0}, skip{0};
+  if (const auto current = capture_epoch.load(std::memory_order_relaxed); current != epoch) {
+    // a new sink starts with the next solve on every thread
+    epoch = current;
+    skip  = 0;
+  }
+  if (skip > 0) {
+    --skip;
+    return false;
+  }
+  skip = capture_every.load(std::memory_order_relaxed) - 1;
+  return true;
+}
+
+/// @brief Reads the installed sink and keeps it alive until destroyed
+class CaptureUse
+{
+public:
+  CaptureUse()
+  {
+    // counted before the sink is read, so reset_capture() either waits for this use or has
+    // already uninstalled the sink
+    capture_users.fetch_add(1);
+    sink_ = capture_sink.load();
+  }
+
+  CaptureUse(const CaptureUse &) = delete;
+  CaptureUse & operator=(const CaptureUse &) = delete;
+
+  ~CaptureUse() { capture_users.fetch_sub(1, std::memory_order_release); }
+
+  CaptureSink * sink() const { return sink_; }
+
+private:
+  CaptureSink * sink_;
+};
+
 /// @brief Halfplane represented as inequality ax + by <= c
 struct HalfPlane
 {
@@ -55,7 +163,54 @@ struct HalfPlane
   bool active{true};
 };
 
-inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> &);
+template<std::ranges::range R>
+inline std::vector<HalfPlane> make_halfplanes(Scalar, Scalar, const R &);
+
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status> solve_rows(Scalar, Scalar, const R &);
+
+template<std::ranges::range R>
+inline bool sorted_bounded(const R &);
+
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status> solve_dispatch(Scalar, Scalar, const R &);
+
+inline std::tuple<Scalar, Scalar, Status> solve_columns(
+  Scalar, Scalar, std::size_t, const Scalar *, const Scalar *, const Scalar *, std::ptrdiff_t);
+
+inline std::tuple<Scalar, Scalar, Status>
+unrotate(Scalar, Scalar, Scalar, const std::tuple<Scalar, Scalar, Status> &);
+
+/// @brief Lower and upper chains of a convex polygon, both sorted by x
+template<std::size_t N>
+struct Chains
+{
+  std::array<Point, N> lower{}, upper{};
+  std::size_t nlower{0}, nupper{0};
+};
+
+template<std::size_t N>
+inline Chains<N> make_chains(const std::array<Point, N> &);
+
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve_segment(Scalar, Scalar, const R &, const Point &, const Point &);
+
+inline Scalar angle(Scalar, Scalar);
+
+template<std::ranges::range R>
+inline std::tuple<std::vector<Point>, std::vector<Scalar>>
+feasible_polygon(const R &, bool = false);
+
+template<
+  std::ranges::random_access_range L = std::span<const Point>,
+  std::ranges::random_access_range U = std::span<const Point>>
+inline std::tuple<Scalar, Scalar, Status> solve_impl(
+  std::vector<HalfPlane> &,
+  const L & lower       = {},
+  const U & upper       = {},
+  const Limits & limits = {},
+  Scalar * gap          = nullptr);
 
 }  // namespace detail
 
@@ -63,6 +218,42 @@ inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> &);
 //////// USER INTERFACE ////////
 ////////////////////////////////
 
+/**
+ * @brief Solve 2D linear program with rows sorted by angle
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax * x + ay * y <= b   for (ax, ay, b) in rows
+ *
+ * The normals (ax, ay) must be sorted counter-clockwise, starting anywhere, as for the edges of a
+ * convex polygon. The feasible polygon is then built in a single deque sweep without sorting or
+ * selection. Empty, unbounded and degenerate problems are passed on to the general algorithm.
+ *
+ * solve() calls this function when a linear-time check finds the rows sorted with less than pi
+ * between neighbouring normals, so that the polygon is bounded or empty.
+ *
+ * @param cx, cy objective function
+ * @param rows triplets (ax, ay, b) defining rows of the LP, sorted by angle
+ * @return {xopt, yopt} optimal solution
+ */
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve_sorted(Scalar cx, Scalar cy, const R & rows) requires(
+  std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
+{
+  const Scalar sqnorm = cx * cx + cy * cy;
+
+  if (sqnorm < detail::eps) { return {0, 0, Status::Optimal}; }
+
+  const auto vertices = std::get<0>(detail::feasible_polygon(rows, true));
+
+  if (vertices.empty()) { return detail::solve_rows(cx, cy, rows); }
+
+  const auto & opt = *std::ranges::min_element(
+    vertices, std::less{}, [cx, cy](const Point & p) { return cx * p.x + cy * p.y; });
+
+  return {opt.x, opt.y, Status::Optimal};
+}
+
 /**
  * @brief Solve 2D linear program
  *
@@ -74,15 +265,451 @@ inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> &);
  * @return {xopt, yopt} optimal solution
  *
  * If problem is infeasible yopt = inf
+ *
+ * Sampled problems are passed to the sink installed with set_capture(), if any.
  */
 template<std::ranges::range R>
 inline std::tuple<Scalar, Scalar, Status> solve(Scalar cx, Scalar cy, const R & rows) requires(
   std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
+{
+  const auto run = [&]() { return detail::solve_dispatch(cx, cy, rows); };
+
+  // unsampled solves only read shared state
+  if (
+    detail::capture_sink.load(std::memory_order_relaxed) == nullptr
+    || !detail::capture_sampled()) {
+    return run();
+  }
+
+  const detail::CaptureUse use;
+  CaptureSink * const sink = use.sink();
+  if (sink == nullptr) { return run(); }
+
+  const auto start  = std::chrono::steady_clock::now();
+  const auto result = run();
+  const auto time   = std::chrono::steady_clock::now() - start;
+
+  using Row = std::array<Scalar, 3>;
+  if constexpr (std::is_convertible_v<const R &, std::span<const Row>>) {
+    sink->record(cx, cy, rows, result, time);
+  } else {
+    // reused between calls, only allocates when a thread sees more rows than before
+    thread_local std::vector<Row> copy;
+    copy.clear();
+    for (const auto [a, b, c] : rows) { copy.push_back({a, b, c}); }
+    sink->record(cx, cy, copy, result, time);
+  }
+  return result;
+}
+
+/**
+ * @brief Solve 2D linear program with box bounds
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax * x + ay * y <= b   for (ax, ay, b) in rows
+ *       xmin <= x <= xmax, ymin <= y <= ymax
+ *
+ * The bounds are not added as rows: they seed the search interval and clip the
+ * envelopes directly, which is cheaper than passing them as four extra rows.
+ *
+ * @param cx, cy objective function
+ * @param rows triplets (ax, ay, b) defining rows of the LP
+ * @param box bounds on x and y, if some are infinite the finite ones are passed as rows
+ * @return {xopt, yopt} optimal solution
+ */
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve(Scalar cx, Scalar cy, const R & rows, const Box & box) requires(
+  std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
+{
+  // also rejects nan bounds
+  if (!(box.xmin <= box.xmax && box.ymin <= box.ymax)) {
+    return {0, 0, Status::PrimaryInfeasible};
+  }
+
+  // infinite bounds can not seed the chains, pass the finite ones as rows instead
+  if (!std::isfinite(box.xmin + box.xmax + box.ymin + box.ymax)) {
+    std::vector<std::array<Scalar, 3>> all;
+    for (const auto [a, b, c] : rows) { all.push_back({a, b, c}); }
+    for (const auto & row : std::initializer_list<std::array<Scalar, 3>>{
+           {-1, 0, -box.xmin},
+           {1, 0, box.xmax},
+           {0, -1, -box.ymin},
+           {0, 1, box.ymax},
+         }) {
+      if (std::abs(row[2]) < detail::inf) { all.push_back(row); }
+    }
+    return detail::solve_dispatch(cx, cy, all);
+  }
+
+  const Scalar sqnorm = cx * cx + cy * cy;
+
+  if (sqnorm < detail::eps) {
+    return {
+      std::clamp<Scalar>(0, box.xmin, box.xmax),
+      std::clamp<Scalar>(0, box.ymin, box.ymax),
+      Status::Optimal,
+    };
+  }
+
+  // a box without interior leaves a one-dimensional problem
+  if (box.xmin == box.xmax || box.ymin == box.ymax) {
+    return detail::solve_segment(
+      cx, cy, rows, Point{.x = box.xmin, .y = box.ymin}, Point{.x = box.xmax, .y = box.ymax});
+  }
+
+  const Scalar cP = cy / sqnorm;
+  const Scalar sP = -cx / sqnorm;
+
+  auto input = detail::make_halfplanes(cP, sP, rows);
+
+  // box corners in counter-clockwise order and rotated coordinates (inverse transformation)
+  const auto rotate = [cx, cy](Scalar x, Scalar y) {
+    return Point{.x = cy * x - cx * y, .y = cx * x + cy * y};
+  };
+  std::array<Point, 4> corners{
+    rotate(box.xmin, box.ymin),
+    rotate(box.xmax, box.ymin),
+    rotate(box.xmax, box.ymax),
+    rotate(box.xmin, box.ymax),
+  };
+
+  // scale factor
+  Scalar lambda{1};
+  for (const auto & hp : input) { lambda = std::max(lambda, std::abs(hp.c)); }
+  for (const auto & p : corners) { lambda = std::max({lambda, std::abs(p.x), std::abs(p.y)}); }
+
+  for (auto & hp : input) { hp.c /= lambda; }
+  for (auto & p : corners) {
+    p.x /= lambda;
+    p.y /= lambda;
+  }
+
+  const auto chains = detail::make_chains(corners);
+
+  return detail::unrotate(
+    cP,
+    sP,
+    lambda,
+    detail::solve_impl(
+      input,
+      std::span<const Point>(chains.lower.data(), chains.nlower),
+      std::span<const Point>(chains.upper.data(), chains.nupper)));
+}
+
+/**
+ * @brief Solve 2D linear program within limits
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax * x + ay * y <= b   for (ax, ay, b) in rows
+ *
+ * Gives up when a limit is reached and returns the best feasible point found so far with
+ * Status::Approximate. Its objective value is then at most gap above the optimal value.
+ *
+ * @param cx, cy objective function
+ * @param rows triplets (ax, ay, b) defining rows of the LP
+ * @param limits iteration and time limits
+ * @return {xopt, yopt, status, gap} solution and optimality gap
+ *
+ * If no feasible point is known when giving up gap = inf
+ */
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status, Scalar>
+solve(Scalar cx, Scalar cy, const R & rows, const Limits & limits) requires(
+  std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
 {
   const Scalar sqnorm = cx * cx + cy * cy;
 
+  if (sqnorm < detail::eps) { return {0, 0, Status::Optimal, 0}; }
+
+  if (std::ranges::empty(rows)) { return {0, 0, Status::DualInfeasible, 0}; }
+
+  const Scalar cP = cy / sqnorm;
+  const Scalar sP = -cx / sqnorm;
+
+  auto input = detail::make_halfplanes(cP, sP, rows);
+
+  // scale factor
+  Scalar lambda{1};
+  for (const auto & hp : input) { lambda = std::max(lambda, std::abs(hp.c)); }
+
+  for (auto & hp : input) { hp.c /= lambda; }
+
+  Scalar gap{0};
+  const auto [xopt, yopt, status] = detail::unrotate(
+    cP,
+    sP,
+    lambda,
+    detail::solve_impl(input, std::span<const Point>{}, std::span<const Point>{}, limits, &gap));
+
+  return {xopt, yopt, status, lambda * gap};
+}
+
+/**
+ * @brief Solve 2D linear program with rows given as columns
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax[i] * x + ay[i] * y <= b[i]   for all i
+ *
+ * Reads the coefficients in place, without building a range of triplets.
+ *
+ * @param cx, cy objective function
+ * @param ax, ay, b columns of equal length defining rows of the LP
+ * @return {xopt, yopt} optimal solution
+ *
+ * If the columns differ in length the status is Status::InvalidInput
+ */
+inline std::tuple<Scalar, Scalar, Status> solve(
+  Scalar cx,
+  Scalar cy,
+  std::span<const Scalar> ax,
+  std::span<const Scalar> ay,
+  std::span<const Scalar> b)
+{
+  if (ay.size() != ax.size() || b.size() != ax.size()) { return {0, 0, Status::InvalidInput}; }
+
+  return detail::solve_columns(cx, cy, ax.size(), ax.data(), ay.data(), b.data(), 1);
+}
+
+/**
+ * @brief Solve 2D linear program with rows given as a strided matrix
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax * x + ay * y <= b   for (ax, ay, b) in rows
+ *
+ * Reads the coefficients in place, e.g. from an Eigen matrix or an mdspan.
+ *
+ * @param cx, cy objective function
+ * @param rows view of the n x 3 matrix with rows (ax, ay, b)
+ * @return {xopt, yopt} optimal solution
+ */
+inline std::tuple<Scalar, Scalar, Status> solve(Scalar cx, Scalar cy, const MatrixView & rows)
+{
+  return detail::solve_columns(
+    cx,
+    cy,
+    rows.rows,
+    rows.data,
+    rows.data + rows.col_stride,
+    rows.data + 2 * rows.col_stride,
+    rows.row_stride);
+}
+
+/**
+ * @brief Rows that are preprocessed once and shared between many solves
+ *
+ * If the rows define a bounded polygon it is stored with its vertices, and solves with
+ * k additional rows only touch O(log n) of them. Otherwise the rows are kept as they are.
+ *
+ * A Prepared is never modified by solve() and can be shared read-only between threads.
+ */
+struct Prepared
+{
+  /// rows (ax, ay, b), only kept if the polygon is unbounded or degenerate
+  std::vector<std::array<Scalar, 3>> rows{};
+  /// vertices of the feasible polygon in counter-clockwise order
+  std::vector<Point> vertices{};
+  /// angle of edge from vertex i to vertex i + 1, increasing
+  std::vector<Scalar> angles{};
+  /// largest vertex coordinate
+  Scalar radius{0};
+  /// rows are infeasible
+  bool infeasible{false};
+};
+
+/**
+ * @brief Preprocess rows for repeated solves
+ *
+ * @param rows triplets (ax, ay, b) defining rows of the LP
+ * @return structure to pass to solve() together with additional rows
+ */
+template<std::ranges::range R>
+inline Prepared prepare(const R & rows) requires(
+  std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
+{
+  Prepared ret;
+
+  if (std::get<2>(detail::solve_rows(0, 1, rows)) == Status::PrimaryInfeasible) {
+    ret.infeasible = true;
+    return ret;
+  }
+
+  std::tie(ret.vertices, ret.angles) = detail::feasible_polygon(rows);
+
+  if (ret.vertices.empty()) {
+    ret.rows.reserve(std::ranges::size(rows));
+    for (const auto [a, b, c] : rows) { ret.rows.push_back({a, b, c}); }
+    return ret;
+  }
+
+  for (const auto & p : ret.vertices) {
+    ret.radius = std::max({ret.radius, std::abs(p.x), std::abs(p.y)});
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Solve 2D linear program with preprocessed rows
+ *
+ *  min  cx * x + cy * y
+ *  s.t. ax * x + ay * y <= b   for (ax, ay, b) in base and rows
+ *
+ * @param cx, cy objective function
+ * @param base rows preprocessed with prepare()
+ * @param rows triplets (ax, ay, b) defining additional rows of the LP
+ * @return {xopt, yopt} optimal solution
+ */
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve(Scalar cx, Scalar cy, const Prepared & base, const R & rows) requires(
+  std::tuple_size_v<std::ranges::range_value_t<R>> == 3)
+{
+  if (base.infeasible) { return {0, 0, Status::PrimaryInfeasible}; }
+
+  if (base.vertices.empty()) {
+    std::vector<std::array<Scalar, 3>> all;
+    all.reserve(base.rows.size() + std::ranges::size(rows));
+    all.insert(all.end(), base.rows.begin(), base.rows.end());
+    for (const auto [a, b, c] : rows) { all.push_back({a, b, c}); }
+    return detail::solve_dispatch(cx, cy, all);
+  }
+
+  const Scalar sqnorm = cx * cx + cy * cy;
+
   if (sqnorm < detail::eps) { return {0, 0, Status::Optimal}; }
 
+  const Scalar cP = cy / sqnorm;
+  const Scalar sP = -cx / sqnorm;
+
+  auto input = detail::make_halfplanes(cP, sP, rows);
+
+  // scale factor, bounds vertices without visiting them
+  Scalar lambda = std::max<Scalar>(1, std::sqrt(2 * sqnorm) * base.radius);
+  for (const auto & hp : input) { lambda = std::max(lambda, std::abs(hp.c)); }
+
+  for (auto & hp : input) { hp.c /= lambda; }
+
+  // vertex in rotated coordinates (inverse transformation)
+  const auto n      = static_cast<int>(base.vertices.size());
+  const auto vertex = [&base, cx, cy, lambda, n](int i) {
+    const auto & p = base.vertices[static_cast<std::size_t>((i + n) % n)];
+    return Point{.x = (cy * p.x - cx * p.y) / lambda, .y = (cx * p.x + cy * p.y) / lambda};
+  };
+
+  // edges that point straight down and up in rotated coordinates separate the chains
+  const Scalar t_down = detail::angle(-cy, -cx);
+  const Scalar t_up   = detail::angle(cy, cx);
+  const auto edge     = [&base, n](auto it) {
+    return static_cast<int>(it - base.angles.begin()) % n;
+  };
+
+  const int lower_begin = edge(std::ranges::upper_bound(base.angles, t_down));
+  const int lower_end   = edge(std::ranges::lower_bound(base.angles, t_up));
+  const int upper_begin = edge(std::ranges::lower_bound(base.angles, t_down));
+  const int upper_end   = edge(std::ranges::upper_bound(base.angles, t_up));
+
+  // lower chain counter-clockwise and upper chain clockwise, both with increasing x
+  const auto lower = std::views::iota(0, (lower_end - lower_begin + n) % n + 1)
+                   | std::views::transform([&](int i) { return vertex(lower_begin + i); });
+  const auto upper = std::views::iota(0, (upper_begin - upper_end + n) % n + 1)
+                   | std::views::transform([&](int i) { return vertex(upper_begin - i); });
+
+  return detail::unrotate(cP, sP, lambda, detail::solve_impl(input, lower, upper));
+}
+
+/**
+ * @brief Install a sink that receives problems passed to solve(cx, cy, rows)
+ *
+ * Only one sink can be installed at a time. The sink must stay alive until it is uninstalled with
+ * reset_capture(). Sampling is counted per thread, so that solves that are not recorded do not
+ * write shared state: each thread records its first solve after the install and then every n:th.
+ *
+ * Only calls to solve(cx, cy, rows) are captured. The overloads with a Box, a Prepared base,
+ * Limits, column spans or a MatrixView, as well as solve_sorted() and prepare(), are not captured,
+ * and neither are the problems they solve internally.
+ *
+ * @param sink receiver of problems, e.g. lp2d::Capture from lp2d/capture.hpp
+ * @param every record every n:th problem on each thread
+ * @return true if the sink was installed, false if another sink is already installed
+ */
+inline bool set_capture(CaptureSink & sink, std::size_t every = 1)
+{
+  CaptureSink * expected{nullptr};
+  if (!detail::capture_sink.compare_exchange_strong(expected, &sink)) { return false; }
+  detail::capture_every.store(std::max<std::size_t>(every, 1), std::memory_order_relaxed);
+  detail::capture_epoch.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Uninstall a sink installed with set_capture(), if it is installed
+ *
+ * Returns when no solve uses the sink anymore, after which it can be destroyed. Must not be called
+ * from the sink itself.
+ *
+ * @param sink receiver of problems
+ */
+inline void reset_capture(CaptureSink & sink)
+{
+  CaptureSink * expected = &sink;
+  detail::capture_sink.compare_exchange_strong(expected, nullptr);
+  // sequentially consistent with the exchange above, pairs with the count and load in CaptureUse
+  while (detail::capture_users.load() != 0) { std::this_thread::yield(); }
+}
+
+////////////////////////////////
+//////// IMPLEMENTATION ////////
+////////////////////////////////
+
+namespace detail
+{
+
+/// @brief Rotate rows so that the objective becomes min y, and normalize them
+template<std::ranges::range R>
+inline std::vector<HalfPlane> make_halfplanes(const Scalar cP, const Scalar sP, const R & rows)
+{
+  std::vector<HalfPlane> ret;
+  ret.reserve(std::ranges::size(rows));
+  for (const auto [a, b, c] : rows) {
+    const double ra = cP * a + sP * b;
+    const double rb = -sP * a + cP * b;
+
+    const double norm = ra * ra + rb * rb;
+
+    if (norm > eps && c < inf) {
+      ret.push_back(HalfPlane{
+        .a      = ra / norm,
+        .b      = rb / norm,
+        .c      = c / norm,
+        .active = true,
+      });
+    }
+  }
+  return ret;
+}
+
+/// @brief Solve 2D linear program with solve_sorted() or solve_rows(), without capture
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve_dispatch(const Scalar cx, const Scalar cy, const R & rows)
+{
+  // fewer than three rows never bound a polygon
+  bool small{false};
+  if constexpr (std::ranges::sized_range<R>) { small = std::ranges::size(rows) < 3; }
+  if (!small && sorted_bounded(rows)) { return solve_sorted(cx, cy, rows); }
+  return solve_rows(cx, cy, rows);
+}
+
+/// @brief Solve 2D linear program with the general algorithm, see solve()
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve_rows(const Scalar cx, const Scalar cy, const R & rows)
+{
+  const Scalar sqnorm = cx * cx + cy * cy;
+
+  if (sqnorm < eps) { return {0, 0, Status::Optimal}; }
+
   if (std::ranges::empty(rows)) { return {0, 0, Status::DualInfeasible}; }
 
   // transformation matrix:
@@ -91,19 +718,92 @@ inline std::tuple<Scalar, Scalar, Status> solve(Scalar cx, Scalar cy, const R &
   const Scalar sP = -cx / sqnorm;
 
   // insert rotated halfplanes with unit vector norm 1
-  std::vector<detail::HalfPlane> input;
-  input.reserve(std::ranges::size(rows));
+  auto input = make_halfplanes(cP, sP, rows);
+
+  // scale factor
+  Scalar lambda{1};
+  for (const auto & hp : input) { lambda = std::max(lambda, std::abs(hp.c)); }
+
+  for (auto & hp : input) { hp.c /= lambda; }
+
+  return unrotate(cP, sP, lambda, solve_impl(input));
+}
+
+/**
+ * @brief Check if row normals are sorted counter-clockwise up to a cyclic shift, with less than
+ * pi between neighbours, so that the rows bound a (possibly empty) polygon
+ *
+ * Compares consecutive normals without trigonometry and stops at the first violation.
+ */
+template<std::ranges::range R>
+inline bool sorted_bounded(const R & rows)
+{
+  // normals in [0, pi) and in [pi, 2 pi)
+  const auto half = [](const Point & v) { return v.y < 0 || (v.y == 0 && v.x < 0); };
+
+  // v follows u counter-clockwise by less than pi, counting the turns through angle 0
+  int turns{0};
+  const auto step = [&half, &turns](const Point & u, const Point & v) {
+    const Scalar tol   = eps * (std::abs(u.x) + std::abs(u.y)) * (std::abs(v.x) + std::abs(v.y));
+    const Scalar cross = u.x * v.y - u.y * v.x;
+    if (cross <= tol && !(cross >= -tol && u.x * v.x + u.y * v.y > 0)) { return false; }
+    if (half(u) && !half(v)) { ++turns; }
+    return turns <= 1;
+  };
+
+  std::optional<Point> first, prev;
   for (const auto [a, b, c] : rows) {
-    const double ra = cP * a + sP * b;
-    const double rb = -sP * a + cP * b;
+    if (a * a + b * b <= eps * eps || c == inf) { continue; }
+    const Point v{.x = a, .y = b};
+    if (!first) {
+      first = v;
+    } else if (!step(*prev, v)) {
+      return false;
+    }
+    prev = v;
+  }
+  return first && step(*prev, *first) && turns == 1;
+}
 
-    const double norm = ra * ra + rb * rb;
+/**
+ * @brief Solve 2D linear program with rows given as strided columns
+ * @param n number of rows
+ * @param ax, ay, b start of the columns
+ * @param stride distance between consecutive rows in the columns
+ */
+inline std::tuple<Scalar, Scalar, Status> solve_columns(
+  const Scalar cx,
+  const Scalar cy,
+  const std::size_t n,
+  const Scalar * ax,
+  const Scalar * ay,
+  const Scalar * b,
+  const std::ptrdiff_t stride)
+{
+  const Scalar sqnorm = cx * cx + cy * cy;
+
+  if (sqnorm < eps) { return {0, 0, Status::Optimal}; }
+
+  if (n == 0) { return {0, 0, Status::DualInfeasible}; }
 
-    if (norm > detail::eps && c < detail::inf) {
-      input.push_back(detail::HalfPlane{
+  const Scalar cP = cy / sqnorm;
+  const Scalar sP = -cx / sqnorm;
+
+  // rotate and normalize like make_halfplanes(), reading the columns in place
+  std::vector<HalfPlane> input;
+  input.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto k = static_cast<std::ptrdiff_t>(i) * stride;
+
+    const Scalar ra   = cP * ax[k] + sP * ay[k];
+    const Scalar rb   = -sP * ax[k] + cP * ay[k];
+    const Scalar norm = ra * ra + rb * rb;
+
+    if (norm > eps && b[k] < inf) {
+      input.push_back(HalfPlane{
         .a      = ra / norm,
         .b      = rb / norm,
-        .c      = c / norm,
+        .c      = b[k] / norm,
         .active = true,
       });
     }
@@ -115,12 +815,21 @@ inline std::tuple<Scalar, Scalar, Status> solve(Scalar cx, Scalar cy, const R &
 
   for (auto & hp : input) { hp.c /= lambda; }
 
-  const auto [xt_opt, yt_opt, status] = solve_impl(input);
+  return unrotate(cP, sP, lambda, solve_impl(input));
+}
+
+/// @brief Map solution of rotated and scaled problem back to original coordinates
+inline std::tuple<Scalar, Scalar, Status> unrotate(
+  const Scalar cP,
+  const Scalar sP,
+  const Scalar lambda,
+  const std::tuple<Scalar, Scalar, Status> & sol)
+{
+  const auto [xt_opt, yt_opt, status] = sol;
 
   // multiplication that returns 0 for 0 * inf (regular multiplication returns nan)
-  const auto mul = [](Scalar a, Scalar b) { return std::abs(a) > detail::eps ? a * b : 0; };
+  const auto mul = [](Scalar a, Scalar b) { return std::abs(a) > eps ? a * b : 0; };
 
-  // return solution in original coordinates
   return {
     lambda * (mul(cP, xt_opt) - mul(sP, yt_opt)),
     lambda * (mul(sP, xt_opt) + mul(cP, yt_opt)),
@@ -128,13 +837,6 @@ inline std::tuple<Scalar, Scalar, Status> solve(Scalar cx, Scalar cy, const R &
   };
 }
 
-////////////////////////////////
-//////// IMPLEMENTATION ////////
-////////////////////////////////
-
-namespace detail
-{
-
 // value and derivative
 using ValDer = std::tuple<Scalar, Scalar>;
 
@@ -201,6 +903,252 @@ inline const auto hfun = [](const std::ranges::range auto & hps, const Scalar x)
   return ret;
 };
 
+/**
+ * @brief Split convex polygon into lower and upper chains
+ * @param ccw polygon vertices in counter-clockwise order
+ */
+template<std::size_t N>
+inline Chains<N> make_chains(const std::array<Point, N> & ccw)
+{
+  const auto find = [&ccw](const auto & proj) -> std::size_t {
+    return std::ranges::min_element(ccw, std::less{}, proj) - ccw.begin();
+  };
+
+  const auto left_lo  = find([](const Point & p) { return std::pair{p.x, p.y}; });
+  const auto right_lo = find([](const Point & p) { return std::pair{-p.x, p.y}; });
+  const auto right_hi = find([](const Point & p) { return std::pair{-p.x, -p.y}; });
+  const auto left_hi  = find([](const Point & p) { return std::pair{p.x, -p.y}; });
+
+  Chains<N> ret;
+  for (auto i = left_lo;; i = (i + 1) % N) {
+    ret.lower[ret.nlower++] = ccw[i];
+    if (i == right_lo) { break; }
+  }
+  for (auto i = right_hi;; i = (i + 1) % N) {
+    ret.upper[ret.nupper++] = ccw[i];
+    if (i == left_hi) { break; }
+  }
+  std::reverse(ret.upper.begin(), ret.upper.begin() + ret.nupper);
+  return ret;
+}
+
+/**
+ * @brief Solve 2D linear program restricted to the segment from p to q
+ *
+ * Every row bounds the segment parameter t in [0, 1] from one side.
+ */
+template<std::ranges::range R>
+inline std::tuple<Scalar, Scalar, Status>
+solve_segment(const Scalar cx, const Scalar cy, const R & rows, const Point & p, const Point & q)
+{
+  const Point d{.x = q.x - p.x, .y = q.y - p.y};
+  const Scalar dnorm = std::abs(d.x) + std::abs(d.y);
+
+  Scalar lo{0}, hi{1};
+  for (const auto [a, b, c] : rows) {
+    const Scalar norm = std::abs(a) + std::abs(b);
+    if (norm <= eps || c == inf) { continue; }
+
+    // a (p + t d) <= c  <==>  ad * t <= slack
+    const Scalar ad    = a * d.x + b * d.y;
+    const Scalar slack = c - a * p.x - b * p.y;
+    if (std::abs(ad) <= eps * norm * dnorm) {
+      if (slack < -eps * std::max<Scalar>(1, std::abs(c))) {
+        return {0, inf, Status::PrimaryInfeasible};
+      }
+    } else if (ad > 0) {
+      hi = std::min(hi, slack / ad);
+    } else {
+      lo = std::max(lo, slack / ad);
+    }
+  }
+
+  if (lo > hi + eps) { return {0, inf, Status::PrimaryInfeasible}; }
+
+  const Scalar t = cx * d.x + cy * d.y < 0 ? std::max(lo, hi) : lo;
+  return {p.x + t * d.x, p.y + t * d.y, Status::Optimal};
+}
+
+/// @brief Angle of vector (x, y) in (-pi, pi]
+inline Scalar angle(const Scalar y, const Scalar x)
+{
+  const Scalar ret = std::atan2(y, x);
+  return ret > -std::numbers::pi ? ret : std::numbers::pi;
+}
+
+/**
+ * @brief Feasible polygon of rows, by sorting them by angle and sweeping a deque
+ * @param rows triplets (a, b, c) defining halfplanes a x + b y <= c
+ * @param sorted rows are already sorted by angle up to a cyclic shift, see solve_sorted()
+ * @return {vertices, angles} polygon vertices in counter-clockwise order and angles of the
+ * edges that start at them, or empty if the polygon is empty, unbounded or degenerate
+ */
+template<std::ranges::range R>
+inline std::tuple<std::vector<Point>, std::vector<Scalar>>
+feasible_polygon(const R & rows, const bool sorted)
+{
+  // boundary line through p with direction d, feasible side to the left
+  struct Line
+  {
+    Point p, d;
+    Scalar angle;
+    bool bounding{false};
+  };
+
+  std::vector<Line> lines;
+  lines.reserve(std::ranges::size(rows) + 4);
+
+  Scalar scale{1};
+  for (const auto [a, b, c] : rows) {
+    const Scalar norm = std::sqrt(a * a + b * b);
+    if (norm > eps && c < inf) {
+      lines.push_back(Line{
+        .p     = {.x = a * c / (norm * norm), .y = b * c / (norm * norm)},
+        .d     = {.x = -b / norm, .y = a / norm},
+        .angle = angle(a, -b),
+      });
+      scale = std::max(scale, std::abs(c / norm));
+    }
+  }
+
+  for (auto & l : lines) {
+    l.p.x /= scale;
+    l.p.y /= scale;
+  }
+
+  // sorted input only needs to start after the wrap-around, where the angle drops the most
+  if (sorted && !lines.empty()) {
+    std::size_t start{0};
+    Scalar drop = lines.back().angle - lines.front().angle;
+    for (auto i = 1u; i < lines.size(); ++i) {
+      if (lines[i - 1].angle - lines[i].angle > drop) {
+        start = i;
+        drop  = lines[i - 1].angle - lines[i].angle;
+      }
+    }
+    std::ranges::rotate(lines, lines.begin() + static_cast<std::ptrdiff_t>(start));
+  }
+  const auto nrows = static_cast<std::ptrdiff_t>(lines.size());
+
+  // polygons that reach this far are treated as unbounded
+  constexpr Scalar M = 1e6;
+  for (const auto & [dx, dy] : {std::pair{0., -1.}, {1., 0.}, {0., 1.}, {-1., 0.}}) {
+    lines.push_back(Line{
+      .p        = {.x = M * dy, .y = -M * dx},
+      .d        = {.x = dx, .y = dy},
+      .angle    = angle(dy, dx),
+      .bounding = true,
+    });
+  }
+
+  if (sorted) {
+    std::ranges::inplace_merge(lines, lines.begin() + nrows, std::less{}, &Line::angle);
+  } else {
+    std::ranges::sort(lines, std::less{}, &Line::angle);
+  }
+
+  const auto cross = [](const Point & u, const Point & v) { return u.x * v.y - u.y * v.x; };
+  const auto out   = [&cross](const Line & l, const Point & q) {
+    return cross(l.d, Point{.x = q.x - l.p.x, .y = q.y - l.p.y}) < -eps;
+  };
+  const auto isec = [&cross](const Line & l1, const Line & l2) {
+    const Point dp{.x = l2.p.x - l1.p.x, .y = l2.p.y - l1.p.y};
+    const Scalar alpha = cross(dp, l2.d) / cross(l1.d, l2.d);
+    return Point{.x = l1.p.x + alpha * l1.d.x, .y = l1.p.y + alpha * l1.d.y};
+  };
+
+  std::deque<Line> dq;
+  for (const auto & l : lines) {
+    while (dq.size() > 1 && out(l, isec(dq[dq.size() - 1], dq[dq.size() - 2]))) { dq.pop_back(); }
+    while (dq.size() > 1 && out(l, isec(dq[0], dq[1]))) { dq.pop_front(); }
+    if (!dq.empty() && std::abs(cross(l.d, dq.back().d)) < eps) {
+      if (l.d.x * dq.back().d.x + l.d.y * dq.back().d.y < 0) { return {}; }
+      if (!out(l, dq.back().p)) { continue; }
+      dq.pop_back();
+    }
+    dq.push_back(l);
+  }
+  while (dq.size() > 2 && out(dq[0], isec(dq[dq.size() - 1], dq[dq.size() - 2]))) { dq.pop_back(); }
+  while (dq.size() > 2 && out(dq[dq.size() - 1], isec(dq[0], dq[1]))) { dq.pop_front(); }
+
+  if (dq.size() < 3 || std::ranges::any_of(dq, &Line::bounding)) { return {}; }
+
+  // vertex i is the start of the edge on line i
+  std::vector<Point> vertices;
+  std::vector<Scalar> angles;
+  vertices.reserve(dq.size());
+  angles.reserve(dq.size());
+  for (auto i = 0u; i < dq.size(); ++i) {
+    const auto p = isec(dq[(i + dq.size() - 1) % dq.size()], dq[i]);
+    vertices.push_back(Point{.x = scale * p.x, .y = scale * p.y});
+    angles.push_back(dq[i].angle);
+  }
+  return {std::move(vertices), std::move(angles)};
+}
+
+// slope of chain segment from p to q
+inline Scalar segment_slope(const Point & p, const Point & q)
+{
+  return q.x > p.x ? (q.y - p.y) / (q.x - p.x) : 0;
+}
+
+// piecewise linear function through chain (sorted by x),    and its subderivative
+template<std::ranges::random_access_range C>
+inline ValSubDer chain_fun(const C & chain, const Scalar x)
+{
+  const auto n = std::ranges::ssize(chain);
+  if (n == 1) { return {chain[0].y, 0, 0}; }
+
+  const auto i = std::clamp<decltype(n)>(
+    std::ranges::upper_bound(chain, x, {}, &Point::x) - std::ranges::begin(chain), 1, n - 1);
+
+  const Point p0 = chain[i - 1];
+  const Point p1 = chain[i];
+  const Scalar s = segment_slope(p0, p1);
+
+  if (std::abs(x - p0.x) <= eps) {  // at vertex p0
+    const Scalar s0 = i > 1 ? segment_slope(chain[i - 2], p0) : s;
+    return {p0.y, std::min(s0, s), std::max(s0, s)};
+  }
+  if (std::abs(x - p1.x) <= eps) {  // at vertex p1
+    const Scalar s1 = i + 1 < n ? segment_slope(p1, chain[i + 1]) : s;
+    return {p1.y, std::min(s, s1), std::max(s, s1)};
+  }
+  return {p0.y + s * (x - p0.x), s, s};
+}
+
+// g(x) clipped from below by a lower chain
+template<std::ranges::random_access_range C>
+inline ValSubDer gfun_clip(const std::vector<HalfPlane> & hps, const C & lower, const Scalar x)
+{
+  const auto ret = gfun(hps, x);
+  if (std::ranges::empty(lower)) { return ret; }
+  const auto clip = chain_fun(lower, x);
+  if (std::get<0>(ret) > std::get<0>(clip) + eps) { return ret; }
+  if (std::get<0>(clip) > std::get<0>(ret) + eps) { return clip; }
+  return {
+    std::max(std::get<0>(ret), std::get<0>(clip)),
+    std::min(std::get<1>(ret), std::get<1>(clip)),
+    std::max(std::get<2>(ret), std::get<2>(clip)),
+  };
+}
+
+// h(x) clipped from above by an upper chain
+template<std::ranges::random_access_range C>
+inline ValSubDer hfun_clip(const std::vector<HalfPlane> & hps, const C & upper, const Scalar x)
+{
+  const auto ret = hfun(hps, x);
+  if (std::ranges::empty(upper)) { return ret; }
+  const auto clip = chain_fun(upper, x);
+  if (std::get<0>(ret) + eps < std::get<0>(clip)) { return ret; }
+  if (std::get<0>(clip) + eps < std::get<0>(ret)) { return clip; }
+  return {
+    std::min(std::get<0>(ret), std::get<0>(clip)),
+    std::min(std::get<1>(ret), std::get<1>(clip)),
+    std::max(std::get<2>(ret), std::get<2>(clip)),
+  };
+}
+
 /// @brief Find candidate optimal point among halfplanes by considering pairwise intersections.
 inline std::optional<Scalar> find_candidate(std::vector<HalfPlane> & hps, Scalar a, Scalar b)
 {
@@ -241,25 +1189,15 @@ inline std::optional<Scalar> find_candidate(std::vector<HalfPlane> & hps, Scalar
         it1_store = {};
       } else {                   // intersection outside--one is redundant
         if (a + eps >= *isec) {  // check for redundancy at a
-          const auto [v1, dv1] = hp_to_yslope(*it1, a);
-          const auto [v2, dv2] = hp_to_yslope(*it2, a);
-          if (v1 + eps < v2) {
-            redundant = 1;
-          } else if (v2 + eps < v1) {
-            redundant = 2;
-          } else {
-            redundant = dv1 <= dv2 ? 1 : 2;
-          }
+          // lines do not cross inside (a, b), so the slopes decide
+          const Scalar dv1 = hp_to_yslope(*it1, a).second;
+          const Scalar dv2 = hp_to_yslope(*it2, a).second;
+          redundant          = dv1 <= dv2 ? 1 : 2;
         } else if (*isec + eps >= b) {  // check for redundancy at b
-          const auto [v1, dv1] = hp_to_yslope(*it1, b);
-          const auto [v2, dv2] = hp_to_yslope(*it2, b);
-          if (v1 + eps < v2) {
-            redundant = 1;
-          } else if (v2 + eps < v1) {
-            redundant = 2;
-          } else {
-            redundant = dv1 >= dv2 ? 1 : 2;
-          }
+          // lines do not cross inside (a, b), so the slopes decide
+          const Scalar dv1 = hp_to_yslope(*it1, b).second;
+          const Scalar dv2 = hp_to_yslope(*it2, b).second;
+          redundant          = dv1 >= dv2 ? 1 : 2;
         }
       }
     } else {  // parallel--so one is redundant
@@ -299,25 +1237,15 @@ inline std::optional<Scalar> find_candidate(std::vector<HalfPlane> & hps, Scalar
         it1_store = {};
       } else {                   // intersection outside--one is redundant
         if (a + eps >= *isec) {  // check for redundancy at a
-          const auto [v1, dv1] = hp_to_yslope(*it1, a);
-          const auto [v2, dv2] = hp_to_yslope(*it2, a);
-          if (v1 + eps < v2) {
-            redundant = 2;
-          } else if (v2 + eps < v1) {
-            redundant = 1;
-          } else {
-            redundant = dv1 <= dv2 ? 2 : 1;
-          }
+          // lines do not cross inside (a, b), so the slopes decide
+          const Scalar dv1 = hp_to_yslope(*it1, a).second;
+          const Scalar dv2 = hp_to_yslope(*it2, a).second;
+          redundant          = dv1 <= dv2 ? 2 : 1;
         } else if (*isec + eps >= b) {  // check for redundancy at b
-          const auto [v1, dv1] = hp_to_yslope(*it1, b);
-          const auto [v2, dv2] = hp_to_yslope(*it2, b);
-          if (v1 + eps < v2) {
-            redundant = 2;
-          } else if (v2 + eps < v1) {
-            redundant = 1;
-          } else {
-            redundant = dv1 >= dv2 ? 2 : 1;
-          }
+          // lines do not cross inside (a, b), so the slopes decide
+          const Scalar dv1 = hp_to_yslope(*it1, b).second;
+          const Scalar dv2 = hp_to_yslope(*it2, b).second;
+          redundant          = dv1 >= dv2 ? 2 : 1;
         }
       }
     } else {  // parallel--so one is redundant
@@ -352,6 +1280,7 @@ inline std::optional<Scalar> find_candidate(std::vector<HalfPlane> & hps, Scalar
 /**
  * @brief Check point
  * @param hps half planes defining LP
+ * @param lower, upper chains that clip g and h (may be empty)
  * @param x point to check
  * @return
  * - 0 if x is optimal
@@ -359,10 +1288,12 @@ inline std::optional<Scalar> find_candidate(std::vector<HalfPlane> & hps, Scalar
  * - 2 if optimal solution is to the right of x (if it exists)
  * - 3 if problem is infeasible
  */
-inline uint8_t check(const std::vector<HalfPlane> & hps, const Scalar x)
+template<std::ranges::random_access_range L, std::ranges::random_access_range U>
+inline uint8_t
+check(const std::vector<HalfPlane> & hps, const L & lower, const U & upper, const Scalar x)
 {
-  const auto [gx, sg, Sg] = gfun(hps, x);
-  const auto [hx, sh, Sh] = hfun(hps, x);
+  const auto [gx, sg, Sg] = gfun_clip(hps, lower, x);
+  const auto [hx, sh, Sh] = hfun_clip(hps, upper, x);
 
   if (gx <= hx + eps) {   // FEASIBLE
     if (gx + eps < hx) {  // there's slack, only g matters
@@ -398,13 +1329,23 @@ inline uint8_t check(const std::vector<HalfPlane> & hps, const Scalar x)
  *
  *  min  y
  *  s.t. a x + by <= c   for (a, b, c) in hps
+ *       y >= lower(x), y <= upper(x)
  *
  * @param hps half plane triplets (a, b, c) defining the LP
+ * @param lower, upper lower and upper chains (sorted by x) of a convex polygon, or empty
+ * @param limits iteration and time limits
+ * @param gap set to optimality gap if not nullptr
  * @return {x, y} optimal solution
  *
  * If problem is infeasible y = inf is returned
  */
-inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> & hps)
+template<std::ranges::random_access_range L, std::ranges::random_access_range U>
+inline std::tuple<Scalar, Scalar, Status> solve_impl(
+  std::vector<HalfPlane> & hps,
+  const L & lower,
+  const U & upper,
+  const Limits & limits,
+  Scalar * gap)
 {
   // halfplanes that define a lower bound on x (independent of y)
   auto hps_x_lower = hps | std::views::filter([](const auto & hp) {
@@ -432,6 +1373,80 @@ inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> & hp
     [](const Scalar a, const Scalar b) { return std::min(a, b); },
     [](const HalfPlane & hp) { return hp.c / hp.a; });
 
+  // the chains bound x from both sides
+  if (!std::ranges::empty(lower)) {
+    a = std::max(a, lower.front().x);
+    b = std::min(b, lower.back().x);
+    if (a > b + eps) { return {0, inf, Status::PrimaryInfeasible}; }
+  }
+
+  if (gap != nullptr) { *gap = 0; }
+
+  // best feasible boundary of [a, b], and lower bound on the optimal value from there
+  const auto interrupt = [&]() -> std::tuple<Scalar, Scalar, Status> {
+    Scalar xbest = 0, ybest = inf;
+    for (const Scalar x : {a, b}) {
+      if (std::abs(x) == inf) { continue; }
+      const Scalar gx = std::get<0>(gfun_clip(hps, lower, x));
+      if (gx <= std::get<0>(hfun_clip(hps, upper, x)) + eps && gx < ybest) {
+        xbest = x;
+        ybest = gx;
+      }
+    }
+
+    // g is convex and lies above its supporting lines at a and b
+    Scalar bound = -inf;
+    if (std::abs(a) < inf && std::abs(b) < inf) {
+      const auto [ga, sga, Sga] = gfun_clip(hps, lower, a);
+      const auto [gb, sgb, Sgb] = gfun_clip(hps, lower, b);
+
+      const auto support = [&](Scalar x) {
+        return std::max(ga + Sga * (x - a), gb + sgb * (x - b));
+      };
+
+      bound = std::min(support(a), support(b));
+      if (Sga != sgb) {
+        const Scalar x = (gb - ga + Sga * a - sgb * b) / (Sga - sgb);
+        if (a < x && x < b) { bound = std::min(bound, support(x)); }
+      }
+    }
+
+    if (gap != nullptr) { *gap = ybest - bound; }
+    return {xbest, ybest, Status::Approximate};
+  };
+
+  // use up one iteration and check time
+  std::size_t iterations{0};
+  const auto exhausted = [&]() {
+    if (++iterations > limits.max_iterations) { return true; }
+    if (limits.deadline == std::chrono::steady_clock::time_point::max()) { return false; }
+    return std::chrono::steady_clock::now() > limits.deadline;
+  };
+
+  // check x and shrink [a, b] accordingly, returns solution if it is found
+  const auto narrow = [&](const Scalar x) -> std::optional<std::tuple<Scalar, Scalar, Status>> {
+    if (exhausted()) { return interrupt(); }
+
+    switch (check(hps, lower, upper, x)) {
+    case 0: {
+      // without lower bounds every point is optimal with value -inf
+      const Scalar y = std::get<0>(gfun_clip(hps, lower, x));
+      return std::tuple{x, y, y == -inf ? Status::DualInfeasible : Status::Optimal};
+      break;
+    }
+    case 1:
+      b = x;
+      break;
+    case 2:
+      a = x;
+      break;
+    case 3:
+      return std::tuple{Scalar{0}, inf, Status::PrimaryInfeasible};
+      break;
+    }
+    return {};
+  };
+
   // we remove at least one halfplane per iterations, so need at most N iterations
   for (auto iter = hps.size(); iter > 0; --iter) {
     const auto x = find_candidate(hps, a, b);
@@ -443,28 +1458,52 @@ inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> & hp
 
     if (!x.has_value()) { break; }
 
-    switch (check(hps, *x)) {
-    case 0:
-      return {*x, std::get<0>(gfun(hps, *x)), Status::Optimal};
-      break;
-    case 1:
-      b = *x;
-      break;
-    case 2:
-      a = *x;
-      break;
-    case 3:
-      return {0, inf, Status::PrimaryInfeasible};
-      break;
+    if (const auto sol = narrow(*x)) { return *sol; }
+  }
+
+  if (!std::ranges::empty(lower)) {
+    // bisect over chain vertices inside (a, b) so that the chains become linear on [a, b]
+    const auto bisect =
+      [&](const auto & chain) -> std::optional<std::tuple<Scalar, Scalar, Status>> {
+      auto lo = std::ranges::upper_bound(chain, a, {}, &Point::x);
+      auto hi = std::ranges::lower_bound(chain, b, {}, &Point::x);
+      while (lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        const Scalar x = (*mid).x;
+        if (const auto sol = narrow(x)) { return sol; }
+        if (b == x) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      return {};
+    };
+
+    if (const auto sol = bisect(lower)) { return *sol; }
+    if (const auto sol = bisect(upper)) { return *sol; }
+
+    // remaining halfplanes may cross the chains inside (a, b)
+    if (a + eps < b) {
+      const Scalar xm = (a + b) / 2;
+      for (const auto & [v, dv, Dv] : {chain_fun(lower, xm), chain_fun(upper, xm)}) {
+        const HalfPlane segment{.a = -dv, .b = 1, .c = v - dv * xm};
+        for (const auto & hp : hps) {
+          const auto isec = intersection(hp, segment);
+          if (isec.has_value() && a + eps < *isec && *isec + eps < b) {
+            if (const auto sol = narrow(*isec)) { return *sol; }
+          }
+        }
+      }
     }
   }
 
   // no intersection points, only need to consider boundaries
-  const auto [ga, sga, Sga] = gfun(hps, a);
-  const auto [ha, sha, Sha] = hfun(hps, a);
+  const auto [ga, sga, Sga] = gfun_clip(hps, lower, a);
+  const auto [ha, sha, Sha] = hfun_clip(hps, upper, a);
 
-  const auto [gb, sgb, Sgb] = gfun(hps, b);
-  const auto [hb, shb, Shb] = hfun(hps, b);
+  const auto [gb, sgb, Sgb] = gfun_clip(hps, lower, b);
+  const auto [hb, shb, Shb] = hfun_clip(hps, upper, b);
 
   if (ga == ha && gb == hb && std::abs(ga) == inf && std::abs(gb) == inf) {
     // special case where bounds are equal and \pm inf
@@ -475,12 +1514,50 @@ inline std::tuple<Scalar, Scalar, Status> solve_impl(std::vector<HalfPlane> & hp
     }
   }
 
-  if (ga > ha && gb > hb) {
+  // feasibility at boundaries, steep or large envelopes are only accurate up to a multiple of eps
+  const auto feasible = [](Scalar g, Scalar h, Scalar sg, Scalar Sg, Scalar sh, Scalar Sh) {
+    const Scalar slope = std::max({std::abs(sg), std::abs(Sg), std::abs(sh), std::abs(Sh)});
+    const Scalar scale = std::min(std::abs(g), std::abs(h));
+    return g <= h + eps * std::max<Scalar>({1, slope, scale});
+  };
+
+  // where g and h are both infinite at x = +-inf, compare the rows that dominate as |x| grows
+  const auto feasible_at_inf = [&hps](Scalar x) {
+    const Scalar d = x > 0 ? 1 : -1;
+    const auto asymptote = [d](const HalfPlane & hp) {
+      const Scalar alpha = -hp.a / hp.b;
+      return std::pair{std::abs(alpha) <= eps ? Scalar{0} : d * alpha, hp.c / hp.b};
+    };
+    std::pair<Scalar, Scalar> g{-inf, -inf}, h{inf, inf};
+    for (const auto & hp : hps | std::views::filter(active_y_lower)) {
+      g = std::max(g, asymptote(hp));
+    }
+    for (const auto & hp : hps | std::views::filter(active_y_upper)) {
+      h = std::min(h, asymptote(hp));
+    }
+    if (std::abs(g.first - h.first) > eps) { return g.first < h.first; }
+    return g.second <= h.second + eps;
+  };
+
+  const bool fa = std::abs(a) == inf && std::abs(ga) == inf && ga == ha
+                  ? feasible_at_inf(a)
+                  : feasible(ga, ha, sga, Sga, sha, Sha);
+  const bool fb = std::abs(b) == inf && std::abs(gb) == inf && gb == hb
+                  ? feasible_at_inf(b)
+                  : feasible(gb, hb, sgb, Sgb, shb, Shb);
+
+  // an endpoint at infinity that only passed the tolerant feasibility check holds no feasible point
+  const auto endpoint = [](Scalar x, Scalar g) -> std::tuple<Scalar, Scalar, Status> {
+    if (g == inf || std::isnan(x)) { return {0, inf, Status::PrimaryInfeasible}; }
+    return {x, g, g == -inf ? Status::DualInfeasible : Status::Optimal};
+  };
+
+  if (!fa && !fb) {
     return {0, 0, Status::PrimaryInfeasible};
-  } else if ((ga <= ha && gb > hb) || ga < gb) {
-    return {a, ga, ga == -inf ? Status::DualInfeasible : Status::Optimal};
+  } else if ((fa && !fb) || (fa && ga < gb)) {
+    return endpoint(a, ga);
   } else {
-    return {b, gb, gb == -inf ? Status::DualInfeasible : Status::Optimal};
+    return endpoint(b, gb);
   }
 }
 
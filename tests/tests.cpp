@@ -24,9 +24,18 @@
 // SOFTWARE.
 
 #include <catch2/catch.hpp>
+#include <lp2d/capture.hpp>
 #include <lp2d/lp2d.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <numbers>
 #include <random>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 TEST_CASE("Basic")
@@ -275,6 +284,52 @@ TEST_CASE("Infeas")
   REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
 }
 
+TEST_CASE("InfeasUnboundedSide")
+{
+  // empty intersection that the search leaves at x = -inf
+  std::vector<std::array<double, 3>> hps{
+    {0.36315533138633116, 0.59681245672762206, -0.99909179479406429},
+    {-0.79882202587716211, -0.60916732252581052, 0.64091419065680433},
+    {0.20584595545962858, -0.49571372118706591, -1.0141806696955427},
+    {-0.48025731332368637, -0.20269762496001209, -0.39710379034895033},
+    {0.75231352750269176, 0.91151129685178112, 0.10706772710405926},
+    {-0.44975502617294982, -0.89375855113390612, 0.41289954475398633},
+    {0.24366898703853446, -0.20564964137348984, 0.15951469315472716},
+  };
+  const auto [xopt, yopt, stat] = lp2d::solve(-0.64590277952531294, -0.26805211753775704, hps);
+  REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
+}
+
+TEST_CASE("InfeasAtInfinity")
+{
+  // g = h = -inf at x = inf is not a feasible point, the optimum is at the other end
+  std::vector<std::array<double, 3>> hps{
+    {0.58361500037500913, -0.70609506422997992, 0.19529871726948755},
+    {0.6281365152738978, 0.2746196905238627, 0.39810436634359614},
+    {-0.72842036458186321, -0.1897822973444161, 0.93712632317535971},
+    {0.97057160866184833, 0.72463034635093271, 0.31273542773708574},
+    {0.79022463528563969, -0.65617444761101007, -0.064144226678539362},
+    {0.85374441140847912, -0.04390361207656146, -0.72134383217289577},
+  };
+  const double cx = 0.49300453556624668, cy = 0.40745548082576644;
+  const auto [xopt, yopt, stat] = lp2d::solve(cx, cy, hps);
+  REQUIRE(stat == lp2d::Status::Optimal);
+  REQUIRE(cx * xopt + cy * yopt == Approx(-0.941873).margin(1e-6));
+}
+
+TEST_CASE("NarrowWedge")
+{
+  // nearly opposite rows with the optimum at a distant apex
+  std::vector<std::array<double, 3>> hps{
+    {-0.17877351230398142, -0.50927607001037323, -0.53390291122286837},
+    {0.20218251650134822, 0.5743132774858617, -0.024445663469676693},
+  };
+  const double cx = -0.93591719480701907, cy = -0.41049085919803974;
+  const auto [xopt, yopt, stat] = lp2d::solve(cx, cy, hps);
+  REQUIRE(stat == lp2d::Status::Optimal);
+  REQUIRE(cx * xopt + cy * yopt == Approx(856.843).epsilon(1e-5));
+}
+
 TEST_CASE("Random")
 {
   std::default_random_engine rng(5);
@@ -302,3 +357,536 @@ TEST_CASE("Random")
     }
   }
 }
+
+TEST_CASE("BoxOnly")
+{
+  std::vector<std::array<double, 3>> hps{};
+  const lp2d::Box box{.xmin = -1, .xmax = 2, .ymin = -3, .ymax = 4};
+  {
+    const auto [xopt, yopt, stat] = lp2d::solve(1, 1, hps, box);
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(xopt == Approx(-1).epsilon(1e-9));
+    REQUIRE(yopt == Approx(-3).epsilon(1e-9));
+  }
+  {
+    const auto [xopt, yopt, stat] = lp2d::solve(-1, 2, hps, box);
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(xopt == Approx(2).epsilon(1e-9));
+    REQUIRE(yopt == Approx(-3).epsilon(1e-9));
+  }
+  {
+    const auto [xopt, yopt, stat] = lp2d::solve(0, -1, hps, box);
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(yopt == Approx(4).epsilon(1e-9));
+  }
+}
+
+TEST_CASE("BoxTilted")
+{
+  std::vector<std::array<double, 3>> hps{
+    {0.001, -1, 2},  // y >= 0.001 x - 2
+  };
+  const lp2d::Box box{.xmin = -1, .xmax = 1, .ymin = -10, .ymax = 10};
+  const auto [xopt, yopt, stat] = lp2d::solve(0, 1, hps, box);
+  REQUIRE(stat == lp2d::Status::Optimal);
+  REQUIRE(xopt == Approx(-1).epsilon(1e-9));
+  REQUIRE(yopt == Approx(-2.001).epsilon(1e-9));
+}
+
+TEST_CASE("BoxInfeas")
+{
+  std::vector<std::array<double, 3>> hps{
+    {1, 1, -3},  // x + y <= -3
+  };
+  {
+    const lp2d::Box box{.xmin = -1, .xmax = 1, .ymin = -1, .ymax = 1};
+    const auto [xopt, yopt, stat] = lp2d::solve(1, 0.5, hps, box);
+    REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
+  }
+  {
+    const lp2d::Box box{.xmin = 1, .xmax = -1, .ymin = -1, .ymax = 1};
+    const auto [xopt, yopt, stat] = lp2d::solve(1, 0.5, hps, box);
+    REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
+  }
+}
+
+TEST_CASE("BoxRandom")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (auto iter = 0u; iter < 100; ++iter) {
+    std::vector<std::array<double, 3>> hps;
+    for (auto i = 0u; i < 25; ++i) { hps.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+
+    const double cx = distr(rng), cy = distr(rng);
+    lp2d::Box box{
+      .xmin = distr(rng) - 1,
+      .xmax = distr(rng) + 1,
+      .ymin = distr(rng) - 1,
+      .ymax = distr(rng) + 1,
+    };
+
+    // boxes without interior
+    if (iter % 4 == 1 || iter % 4 == 3) { box.xmax = box.xmin; }
+    if (iter % 4 == 2 || iter % 4 == 3) { box.ymax = box.ymin; }
+
+    const auto [xopt, yopt, stat] = lp2d::solve(cx, cy, hps, box);
+
+    // same problem with the bounds as rows
+    hps.push_back({1, 0, box.xmax});
+    hps.push_back({-1, 0, -box.xmin});
+    hps.push_back({0, 1, box.ymax});
+    hps.push_back({0, -1, -box.ymin});
+
+    // optimal value over all feasible intersections of two rows
+    std::optional<double> vref;
+    for (auto i = 0u; i < hps.size(); ++i) {
+      for (auto j = i + 1; j < hps.size(); ++j) {
+        const auto [a1, b1, c1] = hps[i];
+        const auto [a2, b2, c2] = hps[j];
+        const double det = a1 * b2 - a2 * b1;
+        if (std::abs(det) < 1e-12) { continue; }
+        const double x = (c1 * b2 - c2 * b1) / det, y = (a1 * c2 - a2 * c1) / det;
+        const auto feasible = [&](const auto & r) { return r[0] * x + r[1] * y <= r[2] + 1e-9; };
+        if (std::ranges::all_of(hps, feasible)) {
+          vref = std::min(vref.value_or(x * cx + y * cy), x * cx + y * cy);
+        }
+      }
+    }
+
+    REQUIRE((stat == lp2d::Status::Optimal) == vref.has_value());
+    if (stat == lp2d::Status::Optimal) {
+      REQUIRE(cx * xopt + cy * yopt == Approx(*vref).margin(1e-9));
+      for (const auto [ax, ay, b] : hps) {
+        REQUIRE(ax * xopt + ay * yopt <= Approx(b).margin(1e-9));
+      }
+    }
+  }
+}
+
+TEST_CASE("BoxDegenerate")
+{
+  std::vector<std::array<double, 3>> hps{
+    {-0.15, -0.38, 2},
+    {0.74, -0.6, 0.27},
+  };
+  const lp2d::Box box{.xmin = -0.4, .xmax = -0.4, .ymin = -1, .ymax = 0.35};
+  const auto [xopt, yopt, stat] = lp2d::solve(-0.28, -1, hps, box);
+  REQUIRE(stat == lp2d::Status::Optimal);
+  REQUIRE(xopt == Approx(-0.4));
+  REQUIRE(yopt == Approx(0.35));
+}
+
+TEST_CASE("BoxInfinite")
+{
+  constexpr double inf = std::numeric_limits<double>::infinity();
+
+  std::vector<std::array<double, 3>> hps{
+    {-1, -1, 0},  // y >= -x
+  };
+  {
+    const lp2d::Box box{.xmin = -inf, .xmax = inf, .ymin = -1, .ymax = 1};
+    const auto [xopt, yopt, stat] = lp2d::solve(0, 1, hps, box);
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(xopt == Approx(1));
+    REQUIRE(yopt == Approx(-1));
+  }
+  {
+    const lp2d::Box box{.xmin = -inf, .xmax = 2, .ymin = -inf, .ymax = inf};
+    const auto [xopt, yopt, stat] = lp2d::solve(0, 1, hps, box);
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(xopt == Approx(2));
+    REQUIRE(yopt == Approx(-2));
+  }
+  {
+    const lp2d::Box box{.xmin = -1, .xmax = inf, .ymin = -inf, .ymax = inf};
+    const auto [xopt, yopt, stat] = lp2d::solve(0, 1, hps, box);
+    REQUIRE(stat == lp2d::Status::DualInfeasible);
+  }
+  {
+    const lp2d::Box box{.xmin = std::nan(""), .xmax = 1, .ymin = -1, .ymax = 1};
+    const auto [xopt, yopt, stat] = lp2d::solve(0, 1, hps, box);
+    REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
+  }
+}
+
+TEST_CASE("PreparedRandom")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (auto iter = 0u; iter < 100; ++iter) {
+    std::vector<std::array<double, 3>> base;
+    for (auto i = 0u; i < 50; ++i) { base.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+
+    const auto prepared = lp2d::prepare(base);
+    REQUIRE(!prepared.vertices.empty());
+
+    for (auto query = 0u; query < 5; ++query) {
+      std::vector<std::array<double, 3>> rows;
+      for (auto i = 0u; i < 3; ++i) { rows.push_back({distr(rng), distr(rng), distr(rng) + 0.5}); }
+
+      const double cx = distr(rng), cy = distr(rng);
+
+      const auto [xopt, yopt, stat] = lp2d::solve(cx, cy, prepared, rows);
+
+      auto all = base;
+      all.insert(all.end(), rows.begin(), rows.end());
+      const auto [xref, yref, sref] = lp2d::solve(cx, cy, all);
+
+      REQUIRE(stat == sref);
+      if (stat == lp2d::Status::Optimal) {
+        REQUIRE(cx * xopt + cy * yopt == Approx(cx * xref + cy * yref).margin(1e-9));
+        for (const auto [ax, ay, b] : all) {
+          REQUIRE(ax * xopt + ay * yopt <= Approx(b).margin(1e-9));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("PreparedUnbounded")
+{
+  std::vector<std::array<double, 3>> base{
+    {0, -1, 2},   // y >= -2
+    {-1, -1, 0},  // y >= -x
+  };
+  const auto prepared = lp2d::prepare(base);
+  REQUIRE(prepared.vertices.empty());
+
+  std::vector<std::array<double, 3>> rows{
+    {1, -1, 2},  // y >= x - 2
+  };
+  const auto [xopt, yopt, stat] = lp2d::solve(0, 1, prepared, rows);
+  REQUIRE(stat == lp2d::Status::Optimal);
+  REQUIRE(yopt == Approx(-1).epsilon(1e-9));
+}
+
+TEST_CASE("PreparedInfeas")
+{
+  std::vector<std::array<double, 3>> base{
+    {0, -1, -0.9},  // y >= -0.9
+    {-1, 1, -2},    // y <= -2 + x
+    {1, 1, 0},      // y <=  -x
+  };
+  const auto prepared = lp2d::prepare(base);
+  REQUIRE(prepared.infeasible);
+
+  std::vector<std::array<double, 3>> rows{};
+  const auto [xopt, yopt, stat] = lp2d::solve(0, 1, prepared, rows);
+  REQUIRE(stat == lp2d::Status::PrimaryInfeasible);
+}
+
+TEST_CASE("LimitsRandom")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  std::size_t approximate = 0;
+
+  for (auto iter = 0u; iter < 100; ++iter) {
+    std::vector<std::array<double, 3>> hps;
+    for (auto i = 0u; i < 100; ++i) { hps.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+
+    const double cx = distr(rng), cy = distr(rng);
+
+    const auto [xref, yref, sref] = lp2d::solve(cx, cy, hps);
+    REQUIRE(sref == lp2d::Status::Optimal);
+
+    const lp2d::Limits limits{.max_iterations = iter % 5};
+    const auto [xopt, yopt, stat, gap] = lp2d::solve(cx, cy, hps, limits);
+
+    if (stat == lp2d::Status::Optimal) {
+      REQUIRE(gap == 0);
+      REQUIRE(cx * xopt + cy * yopt == Approx(cx * xref + cy * yref).margin(1e-9));
+    } else {
+      REQUIRE(stat == lp2d::Status::Approximate);
+      ++approximate;
+      if (gap < std::numeric_limits<double>::infinity()) {
+        for (const auto [ax, ay, b] : hps) {
+          REQUIRE(ax * xopt + ay * yopt <= Approx(b).margin(1e-9));
+        }
+        const double excess = (cx * xopt + cy * yopt) - (cx * xref + cy * yref);
+        REQUIRE(excess >= -1e-9);
+        REQUIRE(excess <= gap + 1e-9);
+      }
+    }
+  }
+
+  REQUIRE(approximate > 0);
+}
+
+TEST_CASE("LimitsDeadline")
+{
+  std::vector<std::array<double, 3>> rows{
+    {0., -1., 2.},    // y >= -2
+    {0., -1., 1.5},   // y >= -1.5
+    {-1., -1., 0.},   // y >= -x (*)
+    {-1., -1., 0.2},  // y >= -x - 0.2
+    {1., -1., 2.},    // y >= x - 2 (*)
+  };
+
+  {
+    // in the past, so that it has passed even on a coarse clock
+    const auto deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    const lp2d::Limits limits{.deadline = deadline};
+    const auto [xopt, yopt, stat, gap] = lp2d::solve(0, 1, rows, limits);
+    REQUIRE(stat == lp2d::Status::Approximate);
+  }
+  {
+    const auto [xopt, yopt, stat, gap] = lp2d::solve(0, 1, rows, lp2d::Limits{});
+    REQUIRE(stat == lp2d::Status::Optimal);
+    REQUIRE(xopt == Approx(1).epsilon(1e-9));
+    REQUIRE(yopt == Approx(-1).epsilon(1e-9));
+    REQUIRE(gap == 0);
+  }
+}
+
+TEST_CASE("Columns")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (auto iter = 0u; iter < 100; ++iter) {
+    std::vector<std::array<double, 3>> hps;
+    for (auto i = 0u; i < 25; ++i) { hps.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+    hps.push_back({0, 0, 1});  // degenerate row is ignored
+
+    const double cx = distr(rng), cy = distr(rng);
+
+    const auto ref = lp2d::solve(cx, cy, hps);
+
+    // separate columns
+    std::vector<double> ax, ay, b;
+    for (const auto [ax_i, ay_i, b_i] : hps) {
+      ax.push_back(ax_i);
+      ay.push_back(ay_i);
+      b.push_back(b_i);
+    }
+    REQUIRE(lp2d::solve(cx, cy, ax, ay, b) == ref);
+
+    // columns of different length
+    const std::span<const double> ay_short(ay.data(), ay.size() - 1);
+    REQUIRE(std::get<2>(lp2d::solve(cx, cy, ax, ay_short, b)) == lp2d::Status::InvalidInput);
+
+    // column-major matrix
+    std::vector<double> colmajor = ax;
+    colmajor.insert(colmajor.end(), ay.begin(), ay.end());
+    colmajor.insert(colmajor.end(), b.begin(), b.end());
+    const lp2d::MatrixView cm{
+      .data       = colmajor.data(),
+      .rows       = hps.size(),
+      .row_stride = 1,
+      .col_stride = static_cast<std::ptrdiff_t>(hps.size()),
+    };
+    REQUIRE(lp2d::solve(cx, cy, cm) == ref);
+
+    // row-major matrix
+    const lp2d::MatrixView rm{
+      .data       = hps.front().data(),
+      .rows       = hps.size(),
+      .row_stride = 3,
+      .col_stride = 1,
+    };
+    REQUIRE(lp2d::solve(cx, cy, rm) == ref);
+  }
+}
+
+TEST_CASE("SortedRandom")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  for (auto iter = 0u; iter < 200; ++iter) {
+    // edges of a random polygon, counter-clockwise and starting anywhere
+    std::vector<double> angles;
+    for (auto i = 0u; i < 30; ++i) { angles.push_back(std::numbers::pi * distr(rng)); }
+    std::ranges::sort(angles);
+    std::ranges::rotate(angles, angles.begin() + iter % angles.size());
+
+    // some problems are infeasible or unbounded
+    const double offset = iter % 10 == 0 ? -0.5 : 1;
+    const auto nrows    = iter % 10 == 1 ? angles.size() / 4 : angles.size();
+
+    std::vector<std::array<double, 3>> rows;
+    for (auto i = 0u; i < nrows; ++i) {
+      const double r = 1 + distr(rng) / 2;
+      rows.push_back({r * std::cos(angles[i]), r * std::sin(angles[i]), r * (distr(rng) + offset)});
+    }
+
+    auto shuffled = rows;
+    std::ranges::shuffle(shuffled, rng);
+
+    const double cx = distr(rng), cy = distr(rng);
+
+    const auto [xopt, yopt, stat] = lp2d::solve_sorted(cx, cy, rows);
+    const auto [xref, yref, sref] = lp2d::solve(cx, cy, shuffled);
+
+    REQUIRE(stat == sref);
+    if (stat == lp2d::Status::Optimal) {
+      REQUIRE(lp2d::solve(cx, cy, rows) == std::tuple{xopt, yopt, stat});
+      REQUIRE(cx * xopt + cy * yopt == Approx(cx * xref + cy * yref).margin(1e-9));
+      for (const auto [ax, ay, b] : rows) {
+        REQUIRE(ax * xopt + ay * yopt <= Approx(b).margin(1e-9));
+      }
+    }
+  }
+}
+
+TEST_CASE("Capture")
+{
+  std::default_random_engine rng(5);
+  std::uniform_real_distribution<double> distr(-1, 1);
+
+  const auto path = (std::filesystem::temp_directory_path() / "lp2d_capture_test.bin").string();
+
+  for (const std::size_t every : {1u, 3u}) {
+    std::vector<lp2d::Record> solved;
+    {
+      const lp2d::Capture capture(path, {.every = every});
+      for (auto iter = 0u; iter < 30; ++iter) {
+        std::vector<std::array<double, 3>> rows;
+        for (auto i = 0u; i < 10; ++i) { rows.push_back({distr(rng), distr(rng), distr(rng) + 1}); }
+        const double cx = distr(rng), cy = distr(rng);
+        const auto result = lp2d::solve(cx, cy, rows);
+        if (iter % every == 0) { solved.push_back({cx, cy, rows, result, {}}); }
+
+        // only one capture at a time, and the log of the active one is left alone
+        if (iter == 0) { REQUIRE_THROWS_AS(lp2d::Capture(path), std::runtime_error); }
+      }
+      REQUIRE(capture.dropped() == 0);
+    }
+
+    // not recorded after the capture is destroyed
+    lp2d::solve(1, 1, std::vector<std::array<double, 3>>{{-1, -1, 0}});
+
+    const auto records = lp2d::read_capture(path);
+    REQUIRE(records.size() == solved.size());
+    for (auto i = 0u; i < records.size(); ++i) {
+      REQUIRE(records[i].cx == solved[i].cx);
+      REQUIRE(records[i].cy == solved[i].cy);
+      REQUIRE(records[i].rows == solved[i].rows);
+      REQUIRE(records[i].result == solved[i].result);
+      REQUIRE(records[i].time.count() > 0);
+    }
+  }
+
+  std::filesystem::remove(path);
+
+  // records that do not fit in the buffer are dropped, the rest are written
+  {
+    std::size_t dropped{0};
+    {
+      // holds all small records (285 bytes each) but not a single large one
+      const lp2d::Capture capture(path, {.buffer_size = 6000});
+      const std::vector<std::array<double, 3>> small(10, {0, -1, 1}), large(300, {0, -1, 1});
+      for (auto iter = 0u; iter < 30; ++iter) { lp2d::solve(0, 1, iter % 3 == 0 ? large : small); }
+      dropped = capture.dropped();
+    }
+    REQUIRE(dropped == 10);
+    REQUIRE(lp2d::read_capture(path).size() == 20);
+  }
+  std::filesystem::remove(path);
+
+  const auto missing = std::filesystem::temp_directory_path() / "lp2d_missing" / "capture.bin";
+  REQUIRE_THROWS_AS(lp2d::Capture(missing.string()), std::runtime_error);
+
+  // a failed capture is not left installed
+  REQUIRE_NOTHROW(lp2d::Capture(path));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("CaptureEntryPoints")
+{
+  const auto path = (std::filesystem::temp_directory_path() / "lp2d_entry_test.bin").string();
+
+  // unbounded, so that the box and prepared overloads fall back to solving rows
+  const std::vector<std::array<double, 3>> rows{{0, -1, 0}, {1, 0, 1}};
+  const std::vector<std::array<double, 3>> query{{-1, 0, 1}};
+  {
+    const lp2d::Capture capture(path);
+    const auto base = lp2d::prepare(rows);
+    lp2d::solve(0, 1, base, query);
+    lp2d::solve(0, 1, rows, lp2d::Box{-1, 1, -1, std::numeric_limits<double>::infinity()});
+    lp2d::solve(0, 1, rows, lp2d::Limits{});
+    lp2d::solve_sorted(0, 1, rows);
+    lp2d::solve(1, 2, rows);
+  }
+
+  // only the last call
+  const auto records = lp2d::read_capture(path);
+  REQUIRE(records.size() == 1);
+  REQUIRE(records[0].cx == 1);
+  REQUIRE(records[0].rows == rows);
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("CaptureTeardown")
+{
+  // counts calls that reach a sink after it has been destroyed
+  struct Sink : lp2d::CaptureSink
+  {
+    explicit Sink(std::atomic<bool> & alive, std::atomic<std::size_t> & late)
+        : alive_(alive), late_(late)
+    {
+      alive_ = true;
+      REQUIRE(lp2d::set_capture(*this));
+    }
+
+    ~Sink() override
+    {
+      lp2d::reset_capture(*this);
+      alive_ = false;
+    }
+
+    void record(
+      double,
+      double,
+      std::span<const std::array<double, 3>>,
+      const std::tuple<double, double, lp2d::Status> &,
+      std::chrono::nanoseconds) override
+    {
+      std::this_thread::yield();
+      if (!alive_) { ++late_; }
+    }
+
+    std::atomic<bool> & alive_;
+    std::atomic<std::size_t> & late_;
+  };
+
+  const auto path = (std::filesystem::temp_directory_path() / "lp2d_teardown_test.bin").string();
+
+  std::atomic<bool> stop{false}, alive{false};
+  std::atomic<std::size_t> late{0};
+
+  std::vector<std::thread> threads;
+  for (auto t = 0u; t < 4; ++t) {
+    threads.emplace_back([&stop, t] {
+      std::default_random_engine rng(t);
+      std::uniform_real_distribution<double> distr(-1, 1);
+      std::vector<std::array<double, 3>> rows(20);
+      while (!stop) {
+        for (auto & [a, b, c] : rows) { a = distr(rng), b = distr(rng), c = distr(rng) + 1; }
+        lp2d::solve(distr(rng), distr(rng), rows);
+      }
+    });
+  }
+
+  for (auto iter = 0u; iter < 200; ++iter) {
+    if (iter % 2 == 0) {
+      const Sink sink(alive, late);
+      std::this_thread::yield();
+    } else {
+      const lp2d::Capture capture(path, {.flush_interval = std::chrono::milliseconds(1)});
+      std::this_thread::yield();
+    }
+  }
+
+  stop = true;
+  for (auto & thread : threads) { thread.join(); }
+
+  REQUIRE(late == 0);
+  std::filesystem::remove(path);
+}
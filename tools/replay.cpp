@@ -0,0 +1,170 @@
+// lp2d: Two-Dimensional Linear Programming
+// https://github.com/pettni/lp2d
+//
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+//
+// Copyright (c) 2021 Petter Nilsson
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Re-run problems recorded by lp2d::Capture and compare results and latency.
+//
+//  usage: lp2d-replay <log> [solve|general|sorted|columns]
+//
+// The sorted engine skips problems whose rows are not sorted, see lp2d::solve_sorted().
+
+#include <lp2d/capture.hpp>
+#include <lp2d/lp2d.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Result = std::tuple<double, double, lp2d::Status>;
+
+struct Engine
+{
+  std::function<Result(const lp2d::Record &)> solve;
+  // problems the engine applies to, others are skipped
+  std::function<bool(const lp2d::Record &)> accepts = [](const lp2d::Record &) { return true; };
+};
+
+const std::map<std::string, Engine> engines{
+  {"solve", {[](const lp2d::Record & r) { return lp2d::solve(r.cx, r.cy, r.rows); }}},
+  {"general",
+   {[](const lp2d::Record & r) { return lp2d::detail::solve_rows(r.cx, r.cy, r.rows); }}},
+  {"sorted",
+   {
+     [](const lp2d::Record & r) { return lp2d::solve_sorted(r.cx, r.cy, r.rows); },
+     [](const lp2d::Record & r) { return lp2d::detail::sorted_bounded(r.rows); },
+   }},
+  {"columns",
+   {[](const lp2d::Record & r) {
+     const lp2d::MatrixView view{
+       .data       = r.rows.empty() ? nullptr : r.rows.front().data(),
+       .rows       = r.rows.size(),
+       .row_stride = 3,
+       .col_stride = 1,
+     };
+     return lp2d::solve(r.cx, r.cy, view);
+   }}},
+};
+
+// results agree if they have the same status and, when optimal, the same objective value
+bool same(const lp2d::Record & r, const Result & res)
+{
+  const auto [x0, y0, s0] = r.result;
+  const auto [x1, y1, s1] = res;
+  if (s0 != s1) { return false; }
+  if (s0 != lp2d::Status::Optimal) { return true; }
+  const double v0 = r.cx * x0 + r.cy * y0;
+  const double v1 = r.cx * x1 + r.cy * y1;
+  return std::abs(v0 - v1) <= 1e-9 * std::max({1., std::abs(v0), std::abs(v1)});
+}
+
+double percentile(std::vector<double> v, double p)
+{
+  if (v.empty()) { return 0; }
+  const auto k = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+  std::ranges::nth_element(v, v.begin() + static_cast<std::ptrdiff_t>(k));
+  return v[k];
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 2 || argc > 3) {
+    std::fprintf(stderr, "usage: %s <log> [solve|general|sorted|columns]\n", argv[0]);
+    return 2;
+  }
+
+  const std::string name = argc == 3 ? argv[2] : "solve";
+  const auto engine      = engines.find(name);
+  if (engine == engines.end()) {
+    std::fprintf(stderr, "unknown engine '%s'\n", name.c_str());
+    return 2;
+  }
+
+  const auto records = lp2d::read_capture(argv[1]);
+  std::printf("%zu problems, engine %s\n", records.size(), name.c_str());
+
+  std::size_t mismatches{0}, skipped{0};
+  std::vector<double> captured_us, replayed_us, ratio;
+  for (auto i = 0u; i < records.size(); ++i) {
+    const auto & r = records[i];
+
+    if (!engine->second.accepts(r)) {
+      ++skipped;
+      continue;
+    }
+
+    engine->second.solve(r);  // warm up caches
+
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = engine->second.solve(r);
+    const auto time   = std::chrono::steady_clock::now() - start;
+
+    captured_us.push_back(std::chrono::duration<double, std::micro>(r.time).count());
+    replayed_us.push_back(std::chrono::duration<double, std::micro>(time).count());
+    ratio.push_back(replayed_us.back() / std::max(captured_us.back(), 1e-3));
+
+    if (!same(r, result)) {
+      ++mismatches;
+      const auto [x0, y0, s0] = r.result;
+      const auto [x1, y1, s1] = result;
+      std::printf(
+        "problem %u (%zu rows): captured (%g, %g, status %d), replayed (%g, %g, status %d)\n",
+        i,
+        r.rows.size(),
+        x0,
+        y0,
+        static_cast<int>(s0),
+        x1,
+        y1,
+        static_cast<int>(s1));
+    }
+  }
+
+  if (skipped > 0) { std::printf("%zu problems skipped, not supported by engine\n", skipped); }
+  std::printf("%zu mismatches\n", mismatches);
+  std::printf("latency [us]     p50        p90        p99        max\n");
+  for (const auto & [label, v] : {
+         std::pair{"captured", &captured_us},
+         {"replayed", &replayed_us},
+         {"ratio", &ratio},
+       }) {
+    std::printf(
+      "%-10s %10.2f %10.2f %10.2f %10.2f\n",
+      label,
+      percentile(*v, 0.5),
+      percentile(*v, 0.9),
+      percentile(*v, 0.99),
+      percentile(*v, 1));
+  }
+
+  return mismatches == 0 ? 0 : 1;
+}